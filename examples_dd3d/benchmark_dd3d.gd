@@ -0,0 +1,186 @@
+extends Node3D
+
+## Headless throughput benchmark for DebugDraw3D.
+##
+## [code]addons/debug_draw_3d[/code] and [code]examples_dd3d[/code] must be placed inside a Godot
+## project, then the benchmark can be started with:
+## [codeblock]
+## godot --headless --path <project> res://examples_dd3d/benchmark_dd3d.tscn -- --output=<file.json>
+## [/codeblock]
+## Every scenario is executed for [member frames_per_scenario] frames and the results are
+## written to [code]--output[/code] as a single JSON document. The same JSON is also printed
+## to stdout, but mixed with the engine output, so only the file is meant to be parsed.
+## [br]The process exits with code 1 if the results could not be written or if any scenario
+## did not receive [DebugDraw3DStats] (e.g. when the no-op release library is loaded).
+## [br]Each scenario reports the number of API calls, the number of primitives
+## (boxes, segments, spheres) and the number of scoped configs it created, since a single
+## [method DebugDraw3D.draw_lines] call can carry a million segments.
+## [br]Memory usage is only reported by debug builds of the engine.
+
+@export var frames_per_scenario := 30
+@export var warmup_frames := 5
+
+var results := []
+var failed := false
+
+
+func _ready() -> void:
+	# Wait for DebugDrawManager to finish its own setup
+	await get_tree().process_frame
+
+	await _run(&"instant_boxes", _instant_boxes)
+	await _run(&"line_segments", _line_segments.bind(_make_segments(1_000_000)))
+	await _run(&"long_duration_spheres", _long_duration_spheres)
+	await _run(&"nested_scoped_configs", _nested_scoped_configs)
+
+	var report := {
+		"godot_version": Engine.get_version_info()["string"],
+		"video_adapter": RenderingServer.get_video_adapter_name(),
+		"frames_per_scenario": frames_per_scenario,
+		"static_memory_peak": OS.get_static_memory_peak_usage(),
+		"scenarios": results,
+	}
+
+	var json := JSON.stringify(report, "\t")
+	print(json)
+
+	var output_path := _get_output_path()
+	if output_path:
+		var file := FileAccess.open(output_path, FileAccess.WRITE)
+		if file:
+			file.store_string(json)
+		else:
+			printerr("Failed to write benchmark results to %s" % output_path)
+			failed = true
+
+	get_tree().quit(1 if failed else 0)
+
+
+## Executes [param scenario] every frame, measures the time spent inside the calls and collects
+## the averaged [DebugDraw3DStats] of the frames that followed.
+func _run(scenario_name: StringName, scenario: Callable) -> void:
+	DebugDraw3D.clear_all()
+	for i in warmup_frames:
+		scenario.call()
+		await get_tree().process_frame
+
+	var submitted_sum := {"calls": 0, "primitives": 0, "scoped_configs": 0}
+	var call_time_usec := 0
+	var stats_sum := {}
+	var stats_frames := 0
+	var memory_start := OS.get_static_memory_usage()
+	var memory_max := memory_start
+	for i in frames_per_scenario:
+		var start := Time.get_ticks_usec()
+		var submitted: Dictionary = scenario.call()
+		call_time_usec += Time.get_ticks_usec() - start
+		for k in submitted:
+			submitted_sum[k] += submitted[k]
+		memory_max = maxi(memory_max, OS.get_static_memory_usage())
+		await get_tree().process_frame
+		memory_max = maxi(memory_max, OS.get_static_memory_usage())
+
+		var render_stats := DebugDraw3D.get_render_stats()
+		if render_stats:
+			_accumulate_stats(stats_sum, render_stats)
+			stats_frames += 1
+
+	if stats_frames == 0:
+		printerr("Scenario %s did not receive any DebugDraw3DStats" % scenario_name)
+		failed = true
+	for k in stats_sum:
+		stats_sum[k] = stats_sum[k] / float(stats_frames)
+
+	var call_time_sec := call_time_usec / 1000000.0
+	var result := {
+		"name": scenario_name,
+		"call_time_usec": call_time_usec,
+		"avg_stats": stats_sum,
+		"static_memory_start": memory_start,
+		"static_memory_max": memory_max,
+		"static_memory_max_delta": memory_max - memory_start,
+	}
+	for k in submitted_sum:
+		result[k] = submitted_sum[k]
+		result[k + "_per_sec"] = submitted_sum[k] / call_time_sec if call_time_usec > 0 else 0.0
+	results.append(result)
+	DebugDraw3D.clear_all()
+
+
+func _accumulate_stats(dict: Dictionary, render_stats: DebugDraw3DStats) -> void:
+	var values := {
+		"total_geometry": render_stats.total_geometry,
+		"instances": render_stats.instances,
+		"lines": render_stats.lines,
+		"total_visible": render_stats.total_visible,
+		"visible_instances": render_stats.visible_instances,
+		"visible_lines": render_stats.visible_lines,
+		"total_time_culling_usec": render_stats.total_time_culling_usec,
+		"time_culling_instant_usec": render_stats.time_culling_instant_usec,
+		"time_culling_delayed_usec": render_stats.time_culling_delayed_usec,
+		"time_filling_buffers_instances_usec": render_stats.time_filling_buffers_instances_usec,
+		"time_filling_buffers_lines_usec": render_stats.time_filling_buffers_lines_usec,
+		"total_time_filling_buffers_usec": render_stats.total_time_filling_buffers_usec,
+		"total_time_spent_usec": render_stats.total_time_spent_usec,
+		"created_scoped_configs": render_stats.created_scoped_configs,
+		"orphan_scoped_configs": render_stats.orphan_scoped_configs,
+	}
+	for k in values:
+		dict[k] = dict.get(k, 0) + values[k]
+
+
+func _get_output_path() -> String:
+	for arg in OS.get_cmdline_user_args():
+		if arg.begins_with("--output="):
+			return arg.trim_prefix("--output=")
+	return ""
+
+
+func _make_segments(count: int) -> PackedVector3Array:
+	var points := PackedVector3Array()
+	points.resize(count * 2)
+	for i in count:
+		var p := Vector3(i % 1000, 0, floori(i / 1000.0)) * 0.1
+		points[i * 2] = p
+		points[i * 2 + 1] = p + Vector3.UP
+	return points
+
+
+# Scenarios return the number of "calls", "primitives" and "scoped_configs" they submitted.
+
+func _instant_boxes() -> Dictionary:
+	var count := 100_000
+	for i in count:
+		DebugDraw3D.draw_box(Vector3(i % 100, floori(i / 10000.0), floori(i / 100.0) % 100), Quaternion.IDENTITY, Vector3.ONE, Color.GREEN)
+	return {"calls": count, "primitives": count}
+
+
+func _line_segments(points: PackedVector3Array) -> Dictionary:
+	DebugDraw3D.draw_lines(points, Color.YELLOW)
+	return {"calls": 1, "primitives": floori(points.size() / 2.0)}
+
+
+func _long_duration_spheres() -> Dictionary:
+	# Each frame adds a new layer of spheres that stay alive until the end of the scenario
+	var count := 2_000
+	var y := Engine.get_process_frames() % 100
+	for i in count:
+		DebugDraw3D.draw_sphere(Vector3(i % 50, y, floori(i / 50.0)), 0.4, Color.CORNFLOWER_BLUE, 60.0)
+	return {"calls": count, "primitives": count}
+
+
+func _nested_scoped_configs() -> Dictionary:
+	var depth := 32
+	var count := 1_000
+	for i in count:
+		_nested_scope(depth, Vector3(i % 32, 0, floori(i / 32.0)))
+	# Every level calls new_scoped_config(), set_thickness() and draw_box()
+	return {"calls": count * depth * 3, "primitives": count * depth, "scoped_configs": count * depth}
+
+
+func _nested_scope(depth: int, pos: Vector3) -> void:
+	if depth == 0:
+		return
+	var _s = DebugDraw3D.new_scoped_config().set_thickness(depth * 0.001)
+	DebugDraw3D.draw_box(pos + Vector3.UP * depth, Quaternion.IDENTITY, Vector3.ONE * 0.5, Color.ORANGE)
+	_nested_scope(depth - 1, pos)